@@ -54,6 +54,11 @@ constexpr unsigned long IDLE_READ_INTERVAL = 5000UL;   // อ่านค่า
 constexpr unsigned long COOLDOWN_TIME      = 30000UL;  // พักระบบ 30 วินาทีหลังทำงาน
 constexpr unsigned long LCD_UPDATE_INTERVAL = 500UL;   // อัพเดท LCD ทุก 500 มิลลิวินาที
 
+// การรดน้ำแบบ Pulse-and-Soak: แบ่งปริมาณน้ำเป็นช่วงสั้นๆ แล้วพักให้น้ำซึมก่อนวัดค่าใหม่
+constexpr unsigned long PUMP_PULSE_TIME     = 1500UL;   // เวลาเปิดปั๊มต่อ 1 Pulse
+constexpr unsigned long SOAK_TIME           = 10000UL;  // เวลาพักให้น้ำซึมระหว่าง Pulse
+constexpr unsigned long PUMP_MIN_PULSE_TIME = 500UL;    // เศษที่เหลือน้อยกว่านี้ให้รวมเข้ากับ Pulse สุดท้าย ไม่เปิด Pulse สั้นๆ
+
 // ค่าสำหรับการอ่าน Sensor
 constexpr int SENSOR_SAMPLES     = 10;   // จำนวนครั้งในการอ่านค่าเฉลี่ย
 constexpr int SENSOR_MIN_VALID   = 0;    // ค่าต่ำสุดที่ถูกต้อง
@@ -61,6 +66,30 @@ constexpr int SENSOR_MAX_VALID   = 1023; // ค่าสูงสุดที่
 constexpr int SENSOR_EDGE_LOW    = 10;   // ค่าขอบล่าง (อาจมีปัญหา)
 constexpr int SENSOR_EDGE_HIGH   = 1013; // ค่าขอบบน (อาจมีปัญหา)
 
+// ค่าสำหรับตรวจสุขภาพ Sensor แบบ Streaming (อัพเดททุกครั้งที่อ่าน ADC)
+// Variance คิดภายในการอ่าน 1 ครั้ง (SENSOR_SAMPLES ค่า) เพื่อไม่ให้การเปลี่ยนแปลงจริงของดินถูกนับเป็น Noise
+constexpr int      SENSOR_NOISE_MAX          = 30;    // ส่วนเบี่ยงเบนมาตรฐานสูงสุดภายในการอ่าน 1 ครั้ง (ค่า ADC)
+constexpr int      SENSOR_FLATLINE_TOLERANCE = 2;     // ค่าที่ต่างจากค่าอ้างอิงไม่เกินนี้ถือว่า "ค้าง" (เผื่อ ADC แกว่ง ±1)
+constexpr unsigned long SENSOR_FLATLINE_TIME = 86400000UL;  // ค้างนิ่งนาน 24 ชั่วโมงจึงถือว่า Probe ค้าง (ดินปกติอาจนิ่งได้หลายชั่วโมง เช่น กลางคืน)
+constexpr uint8_t  SENSOR_BASELINE_SHIFT     = 10;    // EMA ของ Baseline: alpha = 1/1024 ต่อการอ่าน
+constexpr int      SENSOR_DRIFT_MARGIN       = 100;   // Baseline ออกนอกช่วงควบคุมเกินนี้ให้เตือน (ไม่ถือเป็น Error)
+
+// ค่าสำหรับการคาดการณ์แนวโน้มความชื้น (Trend Prediction)
+// ใช้ Linear Regression แบบ Fixed-point กับค่าล่าสุดใน Ring Buffer เพื่อเริ่มรดน้ำก่อนถึงขีดจำกัด
+constexpr uint8_t       PREDICT_WINDOW          = 8;        // จำนวนค่าที่เก็บใน Ring Buffer
+constexpr uint8_t       PREDICT_MIN_SAMPLES     = 4;        // จำนวนค่าขั้นต่ำก่อนเริ่มคาดการณ์
+constexpr unsigned long PREDICT_SAMPLE_INTERVAL = 5000UL;   // เก็บค่าลง Buffer ทุก 5 วินาที (เท่ากับรอบอ่านค่าใน IDLE)
+constexpr unsigned long PREDICT_LEAD_TIME       = 60000UL;  // รดน้ำล่วงหน้าถ้าจะแห้งภายใน 60 วินาที
+constexpr long          PREDICT_MIN_SLOPE_Q8    = 64;       // ความชันขั้นต่ำ 0.25 หน่วย/ตัวอย่าง (Q8) กรอง Noise
+constexpr int           PREDICT_MIN_LEVEL       = MOISTURE_DRY_THRESHOLD - HYSTERESIS;  // ต่ำกว่านี้ไม่คาดการณ์
+constexpr unsigned long PUMP_MIN_RUN_TIME       = 1000UL;   // เวลาเปิดปั๊มขั้นต่ำเมื่อรดน้ำล่วงหน้า
+constexpr unsigned long PUMP_MS_PER_COUNT       = 100UL;    // เวลาเปิดปั๊มต่อค่าความชื้นที่ต้องลด 1 หน่วย
+
+// ค่าสำหรับการตรวจสอบหน่วยความจำ (SRAM 2 KB ของ Uno)
+constexpr uint8_t MEMORY_CANARY         = 0xC5;  // ค่าที่ระบายลง RAM ว่างตอนเริ่มต้น
+constexpr int     MEMORY_PAINT_GUARD    = 16;    // เว้นระยะใต้ Stack ตอนระบายค่า (ไบต์)
+constexpr int     MEMORY_WARN_THRESHOLD = 256;   // เตือนเมื่อ RAM ว่างต่ำสุดน้อยกว่านี้ (ไบต์)
+
 // สถานะ Relay (Active-Low)
 constexpr uint8_t RELAY_ON  = LOW;
 constexpr uint8_t RELAY_OFF = HIGH;
@@ -76,6 +105,31 @@ enum class SystemState : uint8_t {
   COOLDOWN    // พักหลังทำงาน
 };
 
+// =============================================
+// Enum สำหรับสาเหตุความผิดปกติของ Sensor (Sensor Fault Enum)
+// =============================================
+
+enum class SensorFault : uint8_t {
+  NONE,          // ปกติ
+  FLATLINE,      // ค่าค้างนิ่งนานผิดปกติ (เช่น Probe ผุกร่อน)
+  NOISY,         // ค่าแกว่งมากเกินไป
+  DISCONNECTED   // ค่าติดขอบ (สายหลุดหรือลัดวงจร)
+};
+
+// =============================================
+// Enum สำหรับจุดวัดความลึก Stack (Stack Probe Enum)
+// =============================================
+
+enum class StackProbe : uint8_t {
+  LOOP,          // loop()
+  READ_SENSOR,   // readSoilMoisture()
+  UPDATE_STATE,  // updateSystemState()
+  PREDICT,       // predictPumpRunTime()
+  PRINT_STATUS,  // printSystemStatus()
+  UPDATE_LCD,    // updateLcdDisplay()
+  COUNT
+};
+
 // =============================================
 // ตัวแปรสถานะ (State Variables)
 // =============================================
@@ -92,6 +146,57 @@ int currentMoisture = 512;  // ค่าเริ่มต้นกลางๆ
 int previousMoisture = 512;
 
 bool sensorError = false;
+SensorFault sensorFault = SensorFault::NONE;  // สาเหตุของ sensorError
+
+unsigned long pumpRunTime = PUMP_RUN_TIME;  // เวลาเปิดปั๊มของรอบรดน้ำปัจจุบัน
+
+// ตัวแปรสำหรับการรดน้ำแบบ Pulse-and-Soak
+bool pumpRunning = false;
+unsigned long wateringPhaseStart = 0;    // เวลาเริ่ม Pulse หรือช่วง Soak ปัจจุบัน
+unsigned long wateringPumpOnTime = 0;    // เวลาเปิดปั๊มสะสมในรอบนี้ (วัดจริง)
+unsigned long wateringPulseTime = 0;     // เวลาเปิดปั๊มตามแผนของ Pulse ปัจจุบัน
+unsigned long wateringDoseLeft = 0;      // ปริมาณตามแผนที่ยังไม่ได้จัดเข้า Pulse ใด
+uint8_t wateringPulseCount = 0;
+bool wateringFastDrain = false;          // ดินแห้งเร็วกว่าที่ Pulse-and-Soak รดทัน (ข้ามการพัก)
+
+// =============================================
+// ตัวแปรสำหรับการคาดการณ์แนวโน้ม (Trend Prediction Variables)
+// =============================================
+
+int16_t moistureHistory[PREDICT_WINDOW];  // Ring Buffer ของค่าความชื้น
+uint8_t moistureHistoryHead = 0;          // ตำแหน่งที่จะเขียนค่าถัดไป
+uint8_t moistureHistoryCount = 0;         // จำนวนค่าที่มีใน Buffer
+unsigned long lastPredictSampleTime = 0;
+
+// =============================================
+// ตัวแปรสำหรับตรวจสุขภาพ Sensor (Sensor Health Variables)
+// =============================================
+
+// Welford Variance ของการอ่านครั้งปัจจุบัน (ค่าเฉลี่ยแบบ Q4, M2 แบบ Q8)
+uint8_t healthSampleCount = 0;
+long healthMeanQ4 = 0;
+unsigned long healthM2 = 0;
+
+// ช่วงเวลาที่ค่าค้างนิ่งอยู่ใกล้ค่าอ้างอิง
+int healthRunAnchor = -1;
+unsigned long healthRunStart = 0;
+
+// Baseline EMA แบบช้า (Q8) เริ่มที่กึ่งกลางช่วงควบคุม
+long healthBaselineQ8 = (long)((MOISTURE_DRY_THRESHOLD + MOISTURE_WET_THRESHOLD) / 2) * 256;
+
+SensorFault healthFault = SensorFault::NONE;  // ผลตรวจจากการอ่านครั้งล่าสุด
+bool healthDriftWarning = false;              // Baseline อยู่นอกช่วงควบคุม (เตือนเท่านั้น)
+
+// =============================================
+// ตัวแปรสำหรับตรวจสอบหน่วยความจำ (Memory Monitoring Variables)
+// =============================================
+
+// สัญลักษณ์จาก Linker ของ avr-libc: จุดเริ่มต้น Heap และขอบบนของ Heap ปัจจุบัน
+extern "C" char __heap_start;
+extern "C" char* __brkval;
+
+// ความลึก Stack สูงสุด (ไบต์) ที่วัดได้ตอนเข้าแต่ละฟังก์ชัน
+uint16_t stackDepthPeak[(uint8_t)StackProbe::COUNT];
 
 // =============================================
 // LCD Display Object (ออบเจ็กต์จอ LCD)
@@ -170,12 +275,26 @@ void createLcdCustomChars();
 // ฟังก์ชันอ่านค่า Sensor
 int readSoilMoisture();
 bool validateSensorReading(int reading);
+void updateSensorHealth(int raw);
+void evaluateSensorHealth();
+const __FlashStringHelper* getSensorFaultName(SensorFault fault);
+
+// ฟังก์ชันคาดการณ์แนวโน้มความชื้น
+void recordMoistureSample(int moisture);
+void resetMoisturePrediction();
+unsigned long predictPumpRunTime(int moisture);
 
 // ฟังก์ชัน State Machine
 void updateSystemState(int moisture);
 void executeState();
 void transitionTo(SystemState newState);
 
+// ฟังก์ชันรดน้ำแบบ Pulse-and-Soak
+void startWateringCycle();
+void planWateringPulse();
+void updateWateringPulses();
+void finishWateringCycle();
+
 // ฟังก์ชันควบคุมอุปกรณ์
 void startPump();
 void stopPump();
@@ -198,8 +317,17 @@ const char* getLcdStateName(SystemState state);
 const char* getLcdMoistureStatus(int moisture);
 int getMoisturePercent(int rawValue);
 
+// ฟังก์ชันตรวจสอบหน่วยความจำ
+void paintFreeMemory();
+void recordStackDepth(StackProbe probe);
+int getFreeMemory();
+int getMinFreeMemory();
+void printMemoryStatus();
+const __FlashStringHelper* getStackProbeName(StackProbe probe);
+
 // ฟังก์ชันช่วยเหลือ
 unsigned long getElapsedTime(unsigned long startTime);
+char* getHeapEnd();
 
 // ฟังก์ชันสำรอง Relay
 void activateRelay1();
@@ -212,6 +340,9 @@ void deactivateRelay2();
 // =============================================
 
 void setup() {
+  // ระบายค่า Canary ลง RAM ว่างก่อนใช้งานอื่นๆ เพื่อวัด High-water Mark ของ Stack
+  paintFreeMemory();
+
   // เริ่มต้น Serial Monitor สำหรับ Debug
   Serial.begin(9600);
 
@@ -248,6 +379,8 @@ void setup() {
 }
 
 void loop() {
+  recordStackDepth(StackProbe::LOOP);
+
   unsigned long currentTime = millis();
 
   // กำหนดช่วงเวลาอ่านค่าตามสถานะ
@@ -269,6 +402,9 @@ void loop() {
     // อัพเดทสถานะระบบ (ถ้าไม่มีข้อผิดพลาด)
     if (!sensorError) {
       updateSystemState(currentMoisture);
+    } else {
+      // ค่าที่ผิดพลาดทำให้แนวโน้มเชื่อถือไม่ได้
+      resetMoisturePrediction();
     }
   }
 
@@ -351,14 +487,21 @@ void createLcdCustomChars() {
 // =============================================
 
 int readSoilMoisture() {
+  recordStackDepth(StackProbe::READ_SENSOR);
+
   // อ่านค่าหลายครั้งแล้วหาค่าเฉลี่ย เพื่อลด Noise
   long sum = 0;  // ใช้ long เพื่อป้องกัน overflow
 
   for (int i = 0; i < SENSOR_SAMPLES; i++) {
-    sum += analogRead(SOIL_MOISTURE_PIN);
+    int raw = analogRead(SOIL_MOISTURE_PIN);
+    sum += raw;
+    updateSensorHealth(raw);  // ตรวจสุขภาพ Sensor ทุกค่า ADC
     delay(5);  // ลดเวลา delay ลง
   }
 
+  // ประเมินสุขภาพ Sensor จากสถิติของการอ่านครั้งนี้
+  evaluateSensorHealth();
+
   int avgMoisture = (int)(sum / SENSOR_SAMPLES);
 
   // ตรวจสอบความถูกต้องของค่า Sensor
@@ -368,41 +511,204 @@ int readSoilMoisture() {
   }
 
   sensorError = false;
+  sensorFault = SensorFault::NONE;
   return avgMoisture;
 }
 
 bool validateSensorReading(int reading) {
-  // ค่าต้องอยู่ในช่วงที่ถูกต้อง
-  if (reading < SENSOR_MIN_VALID || reading > SENSOR_MAX_VALID) {
-    Serial.println(F("[ERROR] ค่า Sensor ผิดปกติ!"));
+  // ผลตรวจสุขภาพจากสถิติแบบ Streaming (ค่าเฉลี่ยของ analogRead() ไม่มีทางออกนอกช่วง 0-1023)
+  if (healthFault != SensorFault::NONE) {
+    Serial.print(F("[ERROR] Sensor ผิดปกติ: "));
+    Serial.println(getSensorFaultName(healthFault));
+    sensorFault = healthFault;
     return false;
   }
 
-  // เตือนถ้าค่า Sensor ติดที่ขอบ (อาจบ่งชี้ว่า Sensor มีปัญหา)
-  if (reading <= SENSOR_EDGE_LOW) {
-    Serial.println(F("[WARN] Sensor อาจชื้นเกินไปหรือขาดการเชื่อมต่อ"));
-  } else if (reading >= SENSOR_EDGE_HIGH) {
+  // เตือนถ้าค่า Sensor ติดขอบบนแต่ยังแกว่งอยู่ (ขอบล่างถูกตรวจเป็น DISCONNECTED แล้ว)
+  if (reading >= SENSOR_EDGE_HIGH) {
     Serial.println(F("[WARN] Sensor อาจแห้งเกินไปหรือขาดการเชื่อมต่อ"));
   }
 
   return true;
 }
 
+void updateSensorHealth(int raw) {
+  // Flatline: เริ่มจับเวลาใหม่เมื่อค่าออกห่างจากค่าอ้างอิง (นับเป็นเวลา ไม่ขึ้นกับรอบการอ่านของแต่ละสถานะ)
+  if (healthRunAnchor < 0 || abs(raw - healthRunAnchor) > SENSOR_FLATLINE_TOLERANCE) {
+    healthRunAnchor = raw;
+    healthRunStart = millis();
+  }
+
+  // Welford: อัพเดทค่าเฉลี่ยและผลรวมกำลังสองของส่วนต่างทีละค่า
+  healthSampleCount++;
+  long delta = (long)raw * 16 - healthMeanQ4;
+  healthMeanQ4 += delta / healthSampleCount;
+  healthM2 += (unsigned long)(delta * ((long)raw * 16 - healthMeanQ4));
+}
+
+void evaluateSensorHealth() {
+  // ประเมินผลเมื่ออ่านครบ แล้วเริ่ม Welford ใหม่สำหรับการอ่านครั้งถัดไป
+  // (การจับเวลา Flatline และ Baseline ต่อเนื่องข้ามการอ่าน)
+  int readMean = (int)(healthMeanQ4 / 16);
+  unsigned long n = healthSampleCount;
+
+  // Baseline EMA แบบช้าจากค่าเฉลี่ยของการอ่านแต่ละครั้ง
+  healthBaselineQ8 += ((healthMeanQ4 * 16) - healthBaselineQ8) >> SENSOR_BASELINE_SHIFT;
+  int baseline = (int)(healthBaselineQ8 / 256);
+
+  // เปรียบเทียบ Variance (M2/n) กับเกณฑ์โดยไม่ต้องหาร (M2 เป็น Q8)
+  bool noisy = healthM2 > (unsigned long)SENSOR_NOISE_MAX * SENSOR_NOISE_MAX * 256UL * n;
+  bool pinned = healthM2 < 256UL * n;  // ส่วนเบี่ยงเบนมาตรฐานต่ำกว่า 1
+
+  if (readMean <= SENSOR_EDGE_LOW || (readMean >= SENSOR_EDGE_HIGH && pinned)) {
+    // ติดขอบล่าง หรือติดขอบบนแบบนิ่งสนิท = สายหลุด/ลัดวงจร
+    healthFault = SensorFault::DISCONNECTED;
+  } else if (noisy) {
+    healthFault = SensorFault::NOISY;
+  } else if (getElapsedTime(healthRunStart) >= SENSOR_FLATLINE_TIME) {
+    healthFault = SensorFault::FLATLINE;
+    healthRunStart = millis() - SENSOR_FLATLINE_TIME;  // ตรึงไว้ ไม่ให้ millis() ล้นรอบแล้วหายเอง
+  } else {
+    healthFault = SensorFault::NONE;
+  }
+
+  // Baseline ค้างนอกช่วงควบคุม อาจเกิดจาก Probe เสื่อม หรือจากฝั่งต้นไม้ (น้ำหมดถัง, ปั๊มเสีย, รดน้ำเกิน)
+  // แยกไม่ออกจากค่า Sensor อย่างเดียว จึงเตือนแต่ไม่หยุดระบบควบคุม
+  bool drift = baseline > MOISTURE_DRY_THRESHOLD + SENSOR_DRIFT_MARGIN ||
+               baseline < MOISTURE_WET_THRESHOLD - SENSOR_DRIFT_MARGIN;
+  if (drift && !healthDriftWarning) {
+    Serial.println(F("[WARN] Baseline ความชื้นอยู่นอกช่วงควบคุม - ตรวจ Probe, ถังน้ำ และปั๊ม"));
+  }
+  healthDriftWarning = drift;
+
+  healthSampleCount = 0;
+  healthMeanQ4 = 0;
+  healthM2 = 0;
+}
+
+const __FlashStringHelper* getSensorFaultName(SensorFault fault) {
+  switch (fault) {
+    case SensorFault::NONE:         return F("NONE");
+    case SensorFault::FLATLINE:     return F("FLATLINE");
+    case SensorFault::NOISY:        return F("NOISY");
+    case SensorFault::DISCONNECTED: return F("DISCONNECTED");
+    default:                        return F("UNKNOWN");
+  }
+}
+
+// =============================================
+// ฟังก์ชันคาดการณ์แนวโน้มความชื้น (Trend Prediction Functions)
+// =============================================
+
+void recordMoistureSample(int moisture) {
+  // เก็บค่าลง Buffer ตามช่วงเวลาคงที่ เพื่อให้แกน x ของ Regression คือลำดับตัวอย่าง
+  // เผื่อครึ่งรอบอ่านค่าไว้ ไม่ให้ Jitter ของ loop() ทำให้ตัวอย่างหายไปหนึ่งรอบ
+  if (moistureHistoryCount > 0 &&
+      getElapsedTime(lastPredictSampleTime) < PREDICT_SAMPLE_INTERVAL - READ_INTERVAL / 2) {
+    return;
+  }
+  lastPredictSampleTime = millis();
+
+  moistureHistory[moistureHistoryHead] = moisture;
+  moistureHistoryHead = (moistureHistoryHead + 1) % PREDICT_WINDOW;
+  if (moistureHistoryCount < PREDICT_WINDOW) {
+    moistureHistoryCount++;
+  }
+}
+
+void resetMoisturePrediction() {
+  moistureHistoryHead = 0;
+  moistureHistoryCount = 0;
+}
+
+unsigned long predictPumpRunTime(int moisture) {
+  // คืนค่าเวลาเปิดปั๊ม (ms) ถ้าควรรดน้ำล่วงหน้า หรือ 0 ถ้ายังไม่ต้องรดน้ำ
+  recordStackDepth(StackProbe::PREDICT);
+
+  long n = moistureHistoryCount;
+  if (n < PREDICT_MIN_SAMPLES || moisture < PREDICT_MIN_LEVEL) {
+    return 0;
+  }
+
+  // Linear Regression: x = 0 (เก่าสุด) ถึง n-1 (ล่าสุด), y = ค่าความชื้น
+  uint8_t start = (moistureHistoryHead + PREDICT_WINDOW - n) % PREDICT_WINDOW;
+  long sumY = 0;
+  long sumXY = 0;
+  for (uint8_t x = 0; x < n; x++) {
+    int y = moistureHistory[(start + x) % PREDICT_WINDOW];
+    sumY += y;
+    sumXY += (long)x * y;
+  }
+  long sumX = n * (n - 1) / 2;
+  long sumXX = n * (n - 1) * (2 * n - 1) / 6;
+
+  // ความชัน (หน่วยต่อตัวอย่าง) แบบ Fixed-point Q8
+  long slopeQ8 = ((n * sumXY - sumX * sumY) * 256) / (n * sumXX - sumX * sumX);
+  if (slopeQ8 < PREDICT_MIN_SLOPE_Q8) {
+    return 0;  // ดินไม่ได้แห้งลงอย่างชัดเจน
+  }
+
+  // ค่าบนเส้นแนวโน้ม ณ ตัวอย่างล่าสุด (Q8)
+  long trendQ8 = (sumY * 256) / n + slopeQ8 * (n - 1) / 2;
+
+  // เวลาที่เหลือก่อนถึงขีดจำกัดดินแห้ง (นับจากตอนนี้)
+  long deficitQ8 = (long)MOISTURE_DRY_THRESHOLD * 256 - trendQ8;
+  unsigned long timeToDry = 0;
+  if (deficitQ8 > 0) {
+    unsigned long samplesQ4 = (unsigned long)((deficitQ8 * 16) / slopeQ8);
+    timeToDry = samplesQ4 * PREDICT_SAMPLE_INTERVAL / 16;
+  }
+  unsigned long sinceSample = getElapsedTime(lastPredictSampleTime);
+  timeToDry = (timeToDry > sinceSample) ? timeToDry - sinceSample : 0;
+
+  if (timeToDry > PREDICT_LEAD_TIME) {
+    return 0;
+  }
+
+  // ความชื้นที่คาดไว้ ณ สิ้นช่วง Lead Time เทียบกับขอบล่างของ Hysteresis
+  long horizonQ8 = trendQ8 + slopeQ8 * (long)(PREDICT_LEAD_TIME / PREDICT_SAMPLE_INTERVAL);
+  long excess = horizonQ8 / 256 - (MOISTURE_DRY_THRESHOLD - HYSTERESIS);
+  unsigned long runTime = (excess > 0) ? (unsigned long)excess * PUMP_MS_PER_COUNT : 0;
+  if (runTime < PUMP_MIN_RUN_TIME) runTime = PUMP_MIN_RUN_TIME;
+  if (runTime > PUMP_RUN_TIME) runTime = PUMP_RUN_TIME;
+
+  Serial.print(F("[PREDICT] คาดว่าดินจะแห้งใน "));
+  Serial.print(timeToDry / 1000);
+  Serial.print(F("s -> รดน้ำล่วงหน้า "));
+  Serial.print(runTime);
+  Serial.println(F("ms"));
+
+  return runTime;
+}
+
 // =============================================
 // ฟังก์ชัน State Machine (State Management)
 // =============================================
 
 void updateSystemState(int moisture) {
+  recordStackDepth(StackProbe::UPDATE_STATE);
+
   switch (currentState) {
-    case SystemState::IDLE:
+    case SystemState::IDLE: {
+      recordMoistureSample(moisture);
+
       // ตรวจสอบว่าต้องเปลี่ยนสถานะหรือไม่
       if (moisture >= MOISTURE_DRY_THRESHOLD) {
+        pumpRunTime = PUMP_RUN_TIME;
         transitionTo(SystemState::WATERING);
       } else if (moisture <= MOISTURE_WET_THRESHOLD) {
         transitionTo(SystemState::VENTILATING);
+      } else {
+        // คาดการณ์ว่าดินจะแห้งเร็วๆ นี้หรือไม่ ถ้าใช่ให้รดน้ำล่วงหน้า
+        unsigned long predictedRunTime = predictPumpRunTime(moisture);
+        if (predictedRunTime > 0) {
+          pumpRunTime = predictedRunTime;
+          transitionTo(SystemState::WATERING);
+        }
       }
       // ถ้าความชื้นปกติ ก็อยู่ใน IDLE ต่อ
       break;
+    }
 
     case SystemState::WATERING:
       // ตรวจสอบว่าความชื้นดีขึ้นหรือยัง (ใช้ Hysteresis)
@@ -419,7 +725,14 @@ void updateSystemState(int moisture) {
       break;
 
     case SystemState::COOLDOWN:
-      // จะถูกจัดการใน executeState()
+      // ดินยังแห้งถึงขีดจำกัดทั้งที่พักให้น้ำซึมแล้ว แปลว่าดินระบายน้ำเร็วกว่าที่รดทัน จึงไม่รอจนครบเวลาพัก
+      if (moisture >= MOISTURE_DRY_THRESHOLD && getElapsedTime(stateStartTime) >= SOAK_TIME) {
+        Serial.println(F("[COOLDOWN] ดินยังแห้ง - จบช่วงพักก่อนกำหนด"));
+        wateringFastDrain = true;
+        pumpRunTime = PUMP_RUN_TIME;
+        transitionTo(SystemState::WATERING);
+      }
+      // ที่เหลือจะถูกจัดการใน executeState()
       break;
   }
 }
@@ -433,11 +746,8 @@ void executeState() {
       break;
 
     case SystemState::WATERING:
-      // ตรวจสอบเวลาทำงานของปั๊ม
-      if (elapsed >= PUMP_RUN_TIME) {
-        Serial.println(F("[PUMP] หยุดปั๊ม (ครบเวลา)"));
-        transitionTo(SystemState::COOLDOWN);
-      }
+      // สลับระหว่าง Pulse และ Soak จนครบปริมาณหรือถึงเป้าหมาย
+      updateWateringPulses();
       break;
 
     case SystemState::VENTILATING:
@@ -452,6 +762,7 @@ void executeState() {
       // ตรวจสอบว่าพักครบเวลาหรือยัง
       if (elapsed >= COOLDOWN_TIME) {
         Serial.println(F("[COOLDOWN] พักครบเวลา"));
+        wateringFastDrain = false;  // ดินไม่กลับมาแห้งระหว่างพัก กลับไปรดแบบ Pulse-and-Soak
         transitionTo(SystemState::IDLE);
       }
       break;
@@ -463,9 +774,17 @@ void transitionTo(SystemState newState) {
     return; // ไม่มีการเปลี่ยนแปลง
   }
 
+  // สรุปเวลาเปิดปั๊มก่อนออกจากโหมดรดน้ำ
+  if (currentState == SystemState::WATERING) {
+    finishWateringCycle();
+  }
+
   // บันทึกสถานะเก่า
   previousState = currentState;
 
+  // แนวโน้มเดิมใช้ไม่ได้หลังเปลี่ยนสถานะ (เช่น หลังรดน้ำ)
+  resetMoisturePrediction();
+
   // หยุดอุปกรณ์เดิมก่อน
   stopAllDevices();
 
@@ -484,7 +803,7 @@ void transitionTo(SystemState newState) {
       break;
 
     case SystemState::WATERING:
-      startPump();
+      startWateringCycle();
       break;
 
     case SystemState::VENTILATING:
@@ -500,6 +819,88 @@ void transitionTo(SystemState newState) {
   updateLcdDisplay();
 }
 
+// =============================================
+// ฟังก์ชันรดน้ำแบบ Pulse-and-Soak (Pulse-and-Soak Watering Functions)
+// =============================================
+
+void startWateringCycle() {
+  wateringPumpOnTime = 0;
+  wateringPulseCount = 1;
+  wateringDoseLeft = pumpRunTime;
+  planWateringPulse();
+  wateringPhaseStart = millis();
+  startPump();
+}
+
+void planWateringPulse() {
+  // แบ่งตามปริมาณที่วางแผนไว้ ไม่ใช่เวลาที่วัดได้จริง เพื่อไม่ให้ Latency ของ loop() ทำให้ Pulse สุดท้ายหายไป
+  // ถ้าเหลือเศษน้อยกว่า Pulse ขั้นต่ำ ให้รวมเข้ากับ Pulse นี้เลย ส่วนดินที่ระบายน้ำเร็วให้รดทั้งหมดรวดเดียว
+  if (wateringFastDrain || wateringDoseLeft < PUMP_PULSE_TIME + PUMP_MIN_PULSE_TIME) {
+    wateringPulseTime = wateringDoseLeft;
+  } else {
+    wateringPulseTime = PUMP_PULSE_TIME;
+  }
+  wateringDoseLeft -= wateringPulseTime;
+}
+
+void updateWateringPulses() {
+  unsigned long phaseElapsed = getElapsedTime(wateringPhaseStart);
+
+  if (pumpRunning) {
+    if (phaseElapsed >= wateringPulseTime) {
+      stopPump();
+      wateringPumpOnTime += phaseElapsed;
+      wateringPhaseStart = millis();
+
+      if (wateringDoseLeft == 0) {
+        Serial.println(F("[PUMP] หยุดปั๊ม (ครบเวลา)"));
+        transitionTo(SystemState::COOLDOWN);
+      } else {
+        Serial.println(F("[PUMP] หยุดปั๊ม - พักให้น้ำซึม (Soak)"));
+      }
+    }
+  } else if (phaseElapsed >= SOAK_TIME) {
+    // อ่านค่าความชื้นใหม่หลังน้ำซึมแล้ว ก่อนตัดสินใจเปิด Pulse ถัดไป
+    previousMoisture = currentMoisture;
+    currentMoisture = readSoilMoisture();
+    lastReadTime = millis();
+
+    if (sensorError) {
+      // ไม่มีค่าที่เชื่อถือได้ว่าดินชื้นพอหรือยัง จึงไม่เปิด Pulse ถัดไป
+      Serial.println(F("[PUMP] จบรอบรดน้ำ (Sensor ผิดปกติหลังพักน้ำซึม)"));
+      transitionTo(SystemState::COOLDOWN);
+      return;
+    }
+
+    updateSystemState(currentMoisture);  // ออกจาก WATERING ถ้าถึงช่วง Hysteresis แล้ว
+
+    if (currentState == SystemState::WATERING) {
+      wateringPulseCount++;
+      if (currentMoisture >= MOISTURE_DRY_THRESHOLD && !wateringFastDrain) {
+        // ดินยังแห้งถึงขีดจำกัดหลังพักน้ำซึม การพักต่อไปไม่ช่วย ให้รดส่วนที่เหลือรวดเดียว
+        Serial.println(F("[PUMP] ดินยังแห้งหลังพักน้ำซึม - รดส่วนที่เหลือต่อเนื่อง"));
+        wateringFastDrain = true;
+      }
+      planWateringPulse();
+      wateringPhaseStart = millis();
+      startPump();
+    }
+  }
+}
+
+void finishWateringCycle() {
+  // รวมเวลาของ Pulse ที่ยังเปิดอยู่ (กรณีถึงเป้าหมายระหว่าง Pulse)
+  if (pumpRunning) {
+    wateringPumpOnTime += getElapsedTime(wateringPhaseStart);
+  }
+
+  Serial.print(F("[PUMP] รวมเวลาเปิดปั๊มรอบนี้: "));
+  Serial.print(wateringPumpOnTime);
+  Serial.print(F(" ms ("));
+  Serial.print(wateringPulseCount);
+  Serial.println(F(" pulse)"));
+}
+
 // =============================================
 // ฟังก์ชันควบคุมปั๊มน้ำ (Pump Control Functions)
 // =============================================
@@ -508,10 +909,12 @@ void startPump() {
   Serial.println(F(""));
   Serial.println(F(">>> [PUMP] เปิดปั๊มน้ำ - กำลังรดน้ำ..."));
   digitalWrite(RELAY_PUMP_PIN, RELAY_ON);
+  pumpRunning = true;
 }
 
 void stopPump() {
   digitalWrite(RELAY_PUMP_PIN, RELAY_OFF);
+  pumpRunning = false;
 }
 
 // =============================================
@@ -542,6 +945,8 @@ void stopAllDevices() {
 // =============================================
 
 void printSystemStatus(int moisture) {
+  recordStackDepth(StackProbe::PRINT_STATUS);
+
   Serial.println(F("-------------------------------------"));
 
   // แสดงค่าความชื้น
@@ -565,14 +970,19 @@ void printSystemStatus(int moisture) {
 
   // แสดงสถานะอุปกรณ์
   Serial.print(F("Pump: "));
-  Serial.print(currentState == SystemState::WATERING ? F("ON") : F("OFF"));
+  Serial.print(pumpRunning ? F("ON") : F("OFF"));
   Serial.print(F(" | Fan: "));
   Serial.println(currentState == SystemState::VENTILATING ? F("ON") : F("OFF"));
 
   if (sensorError) {
-    Serial.println(F("!!! SENSOR ERROR - Using previous value !!!"));
+    Serial.print(F("!!! SENSOR ERROR ("));
+    Serial.print(getSensorFaultName(sensorFault));
+    Serial.println(F(") - Using previous value !!!"));
   }
 
+  // แสดงสถานะหน่วยความจำ
+  printMemoryStatus();
+
   Serial.println(F("-------------------------------------"));
   Serial.println(F(""));
 }
@@ -623,6 +1033,8 @@ void lcdShowStartupScreen() {
 }
 
 void updateLcdDisplay() {
+  recordStackDepth(StackProbe::UPDATE_LCD);
+
   // แสดงสถานะระบบปัจจุบันบน LCD
   lcdShowSystemStatus();
 }
@@ -727,6 +1139,90 @@ int getMoisturePercent(int rawValue) {
   return percent;
 }
 
+// =============================================
+// ฟังก์ชันตรวจสอบหน่วยความจำ (Memory Monitoring Functions)
+// =============================================
+
+void paintFreeMemory() {
+  // ระบายค่า Canary ตั้งแต่ขอบบนของ Heap ถึงใต้ Stack ปัจจุบัน
+  // ไบต์ที่ยังเป็น Canary อยู่ภายหลัง = ไบต์ที่ Stack ไม่เคยใช้
+  char* p = getHeapEnd();
+  char* stackLimit = (char*)SP - MEMORY_PAINT_GUARD;
+
+  while (p < stackLimit) {
+    *p++ = MEMORY_CANARY;
+  }
+}
+
+void recordStackDepth(StackProbe probe) {
+  // ความลึก Stack ณ จุดที่เรียก (นับจากปลาย RAM)
+  uint16_t depth = (uint16_t)(RAMEND - SP);
+  uint8_t index = (uint8_t)probe;
+
+  if (depth > stackDepthPeak[index]) {
+    stackDepthPeak[index] = depth;
+  }
+}
+
+int getFreeMemory() {
+  // พื้นที่ว่างปัจจุบันระหว่าง Heap และ Stack
+  return (int)((char*)SP - getHeapEnd());
+}
+
+int getMinFreeMemory() {
+  // นับไบต์ Canary ที่ยังไม่ถูกเขียนทับ ไล่จากขอบบนของ Heap ขึ้นไปหา Stack
+  const char* p = getHeapEnd();
+  int untouched = 0;
+
+  while (p < (char*)SP && *p == (char)MEMORY_CANARY) {
+    p++;
+    untouched++;
+  }
+
+  return untouched;
+}
+
+void printMemoryStatus() {
+  int freeRam = getFreeMemory();
+  int minFreeRam = getMinFreeMemory();
+  int stackMax = (int)(RAMEND - (uintptr_t)getHeapEnd()) - minFreeRam;  // ส่วนที่ Stack เคยใช้ทั้งหมด
+
+  // แสดง RAM ว่างปัจจุบัน/ต่ำสุด และ High-water Mark ของ Stack
+  Serial.print(F("RAM Free: "));
+  Serial.print(freeRam);
+  Serial.print(F(" (min "));
+  Serial.print(minFreeRam);
+  Serial.print(F(") bytes | Stack Max: "));
+  Serial.print(stackMax);
+  Serial.println(F(" bytes"));
+
+  // แสดงความลึก Stack สูงสุดของแต่ละฟังก์ชัน
+  Serial.print(F("Stack:"));
+  for (uint8_t i = 0; i < (uint8_t)StackProbe::COUNT; i++) {
+    Serial.print(F(" "));
+    Serial.print(getStackProbeName((StackProbe)i));
+    Serial.print(F("="));
+    Serial.print(stackDepthPeak[i]);
+  }
+  Serial.println(F(""));
+
+  if (minFreeRam < MEMORY_WARN_THRESHOLD) {
+    Serial.println(F("[WARN] RAM ว่างต่ำกว่าขีดจำกัด - เสี่ยง Stack ชน Heap!"));
+  }
+}
+
+const __FlashStringHelper* getStackProbeName(StackProbe probe) {
+  switch (probe) {
+    case StackProbe::LOOP:         return F("loop");
+    case StackProbe::READ_SENSOR:  return F("read");
+    case StackProbe::UPDATE_STATE: return F("state");
+    case StackProbe::PREDICT:      return F("predict");
+    case StackProbe::PRINT_STATUS: return F("status");
+    case StackProbe::UPDATE_LCD:   return F("lcd");
+    default:                       return F("?");
+  }
+}
+
 // =============================================
 // ฟังก์ชันช่วยเหลือ (Utility Functions)
 // =============================================
@@ -742,6 +1238,11 @@ unsigned long getElapsedTime(unsigned long startTime) {
   }
 }
 
+char* getHeapEnd() {
+  // ถ้ายังไม่เคยใช้ malloc() __brkval จะเป็น 0 ให้ใช้จุดเริ่มต้น Heap แทน
+  return (__brkval != 0) ? __brkval : &__heap_start;
+}
+
 // =============================================
 // ฟังก์ชันสำรองสำหรับ Relay 1 และ 2 (Reserved Functions)
 // =============================================
@@ -0,0 +1,71 @@
+/*
+ * จำลองความผิดปกติของ Sensor (Sensor Health Simulation)
+ *
+ * ป้อนสัญญาณแต่ละแบบให้ Firmware 30 ชั่วโมง แล้วรายงานว่าเกิด Sensor Error เมื่อใด
+ *
+ * การใช้งาน: sim_health <scenario>
+ *   healthy   ดินแห้ง/รดน้ำตามปกติ ADC แกว่ง ±3
+ *   stuck     Probe ค้างที่ 450 ±1
+ *   stable    ดินปกติที่นิ่งอยู่ 698 ±1 นาน 20 ชั่วโมง แล้วแห้งลงจนรดน้ำ ต้องไม่ Error
+ *   noisy     ค่าแกว่ง ±150
+ *   open-low  สายหลุด อ่านได้ 0-3
+ *   pinned    ค่าติด 1023 นิ่งสนิท
+ *   dry       ดินแห้งค้างที่ ~1000 (เช่น น้ำหมดถัง) ต้องเตือนแต่ไม่ Error
+ *   steps     ค่ากระโดด 705 <-> 555 ทุก 10 วินาที (หน้าน้ำหลังรดน้ำ) ต้องไม่ Error
+ */
+
+#include <Arduino.h>
+#include <math.h>
+
+#include FIRMWARE
+
+constexpr unsigned long SIM_TIME    = 30UL * 3600 * 1000;
+constexpr unsigned long STABLE_TIME = 20UL * 3600 * 1000;
+constexpr unsigned long STEP_MS     = 10;
+
+const char* scenario = "healthy";
+double soil = 600;
+bool pumpOn = false;
+
+int simAnalogRead(uint8_t) {
+  if (strcmp(scenario, "stuck") == 0)    return 450 + rand() % 3 - 1;
+  if (strcmp(scenario, "noisy") == 0)    return 500 + rand() % 301 - 150;
+  if (strcmp(scenario, "open-low") == 0) return rand() % 4;
+  if (strcmp(scenario, "pinned") == 0)   return 1023;
+  if (strcmp(scenario, "dry") == 0)      return 1000 + rand() % 7 - 3;
+  if (strcmp(scenario, "steps") == 0)    return (simMillis % 20000 < 10000 ? 705 : 555) + rand() % 5 - 2;
+  if (strcmp(scenario, "stable") == 0)   return (int)lround(soil) + rand() % 3 - 1;
+  return (int)lround(soil) + rand() % 7 - 3;
+}
+
+void simDigitalWrite(uint8_t pin, uint8_t value) {
+  if (pin == RELAY_PUMP_PIN) pumpOn = (value == RELAY_ON);
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) scenario = argv[1];
+  bool stable = strcmp(scenario, "stable") == 0;
+  if (stable) soil = 698;
+  srand(2);
+  setup();
+
+  const unsigned long start = simMillis;
+  const unsigned long end = start + SIM_TIME;
+  while (simMillis < end) {
+    loop();
+    simMillis += STEP_MS;
+    if (!stable || simMillis - start >= STABLE_TIME) soil += 12.0 / 60.0 * STEP_MS / 1000.0;
+    if (pumpOn) soil -= 10.0 * STEP_MS / 1000.0;
+
+    if (sensorError) {
+      printf("%-9s fault=%-13s after %5lu s  drift_warning=%s\n", scenario,
+             (const char*)getSensorFaultName(sensorFault), (simMillis - start) / 1000,
+             healthDriftWarning ? "yes" : "no");
+      return 0;
+    }
+  }
+
+  printf("%-9s fault=%-13s               drift_warning=%s\n", scenario, "none",
+         healthDriftWarning ? "yes" : "no");
+  return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * จำลองการคาดการณ์แนวโน้มความชื้น (Trend Prediction Simulation)
+ *
+ * ดินแห้งลงตามอัตราที่กำหนด (ค่า/นาที) ปั๊มลดค่าความชื้น 10 ค่า/วินาที ADC แกว่ง ±3
+ * รันจำลอง 4 ชั่วโมง วัดเวลาที่ดินแห้งเกินขีดจำกัด ค่าสูงสุด และเวลาตั้งแต่ดินแห้ง
+ * เกินขีดจำกัดจนปั๊มเปิด (0 = เปิดก่อนถึงขีดจำกัด)
+ *
+ * การใช้งาน: sim_predict <label> <dry_rate_per_min>
+ */
+
+#include <Arduino.h>
+#include <math.h>
+
+#include FIRMWARE
+
+constexpr double PUMP_RATE_PER_S = 10.0;
+constexpr unsigned long SIM_TIME = 4UL * 3600 * 1000;
+constexpr unsigned long STEP_MS  = 10;
+
+double soil = 600;
+bool pumpOn = false;
+
+int simAnalogRead(uint8_t) { return (int)lround(soil) + rand() % 7 - 3; }
+
+void simDigitalWrite(uint8_t pin, uint8_t value) {
+  if (pin == RELAY_PUMP_PIN) pumpOn = (value == RELAY_ON);
+}
+
+int main(int argc, char** argv) {
+  const char* label = (argc > 1) ? argv[1] : "firmware";
+  double dryRate = (argc > 2) ? atof(argv[2]) : 12.0;
+  srand(1);
+  setup();
+
+  unsigned long dryMs = 0;
+  double peak = 0;
+  double latencySum = 0;
+  int latencyCount = 0;
+  long crossTime = -1;
+  bool wasDry = false;
+  bool wasPumping = false;
+  const unsigned long end = simMillis + SIM_TIME;
+
+  while (simMillis < end) {
+    loop();
+    simMillis += STEP_MS;
+    double dt = STEP_MS / 1000.0;
+
+    soil += dryRate / 60.0 * dt;
+    if (pumpOn) soil -= PUMP_RATE_PER_S * dt;
+    if (soil > 1023) soil = 1023;  // ไม่เกินช่วงของ ADC
+    if (soil > peak) peak = soil;
+
+    bool dry = soil >= MOISTURE_DRY_THRESHOLD;
+    if (dry) dryMs += STEP_MS;
+    if (dry && !wasDry) crossTime = (long)simMillis;
+    wasDry = dry;
+
+    // นับเฉพาะการเปิดปั๊มครั้งแรกของแต่ละรอบ (ไม่นับ Pulse ถัดไป)
+    if (pumpOn && !wasPumping && currentState == SystemState::WATERING && wateringPulseCount == 1) {
+      latencySum += (dry && crossTime >= 0) ? (double)(simMillis - crossTime) : 0.0;
+      latencyCount++;
+      crossTime = -1;
+    }
+    wasPumping = pumpOn;
+  }
+
+  printf("%-16s dry_rate=%4.0f/min  time_dry=%4.1f%%  peak=%4.0f  crossing_to_pump=%5.2f s\n",
+         label, dryRate, 100.0 * dryMs / SIM_TIME, peak, latencyCount ? latencySum / latencyCount / 1000.0 : 0.0);
+  return 0;
+}
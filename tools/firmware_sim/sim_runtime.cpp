@@ -0,0 +1,16 @@
+/*
+ * ตัวแปรส่วนกลางของ Arduino API จำลอง (Host Simulation Runtime)
+ */
+
+#include <Arduino.h>
+
+unsigned long simMillis = 0;
+bool simQuiet = true;
+SimSerial Serial;
+
+extern "C" {
+char simRam[2048];
+extern char __heap_start __attribute__((alias("simRam")));
+char* __brkval = 0;
+}
+uintptr_t simSp = (uintptr_t)(simRam + 1900);
@@ -0,0 +1,104 @@
+/*
+ * จำลองการรดน้ำบนดินแน่น (Dense Substrate Watering Simulation)
+ *
+ * ปั๊มจ่ายน้ำ 10 ml/s ลงผิวดิน ผิวดินขังน้ำได้ 6 ml ส่วนเกินไหลทิ้ง (Runoff)
+ * น้ำซึมลงดิน 3 ml/s และไปถึง Probe ช้ากว่า 4 วินาที น้ำ 1 ml = ค่าความชื้น -2
+ * ดินแห้งลง 12 ค่า/นาที รันจำลอง 4 ชั่วโมง
+ *
+ * สร้างด้วย -DFIRMWARE="path/to/main.cpp" เพื่อเลือก Firmware ที่จะทดสอบ
+ */
+
+#include <Arduino.h>
+#include <math.h>
+
+#include FIRMWARE
+
+constexpr double PUMP_FLOW_ML_S    = 10.0;
+constexpr double SURFACE_CAP_ML    = 6.0;
+constexpr double INFILTRATION_ML_S = 3.0;
+constexpr double PROBE_LAG_S       = 4.0;
+constexpr double COUNTS_PER_ML     = 2.0;
+constexpr double DRY_RATE_PER_MIN  = 12.0;
+constexpr unsigned long SIM_TIME   = 4UL * 3600 * 1000;
+constexpr unsigned long STEP_MS    = 10;
+
+double soil = 705;
+double surfaceMl = 0;
+double wettingFrontMl = 0;
+bool pumpOn = false;
+
+int simAnalogRead(uint8_t) { return (int)lround(soil) + rand() % 5 - 2; }
+
+void simDigitalWrite(uint8_t pin, uint8_t value) {
+  if (pin == RELAY_PUMP_PIN) pumpOn = (value == RELAY_ON);
+}
+
+int main(int argc, char** argv) {
+  const char* label = (argc > 1) ? argv[1] : "firmware";
+  srand(3);
+  setup();
+
+  double pumpedMl = 0;
+  double runoffMl = 0;
+  unsigned long dryMs = 0;
+  unsigned long cycleStart = 0;
+  unsigned long timeToTargetSum = 0;
+  int cycles = 0;
+  int reached = 0;
+  bool awaitingTarget = false;
+  SystemState lastState = currentState;
+  const unsigned long end = simMillis + SIM_TIME;
+
+  while (simMillis < end) {
+    loop();
+    simMillis += STEP_MS;
+    double dt = STEP_MS / 1000.0;
+
+    if (pumpOn) {
+      surfaceMl += PUMP_FLOW_ML_S * dt;
+      pumpedMl += PUMP_FLOW_ML_S * dt;
+    }
+    if (surfaceMl > SURFACE_CAP_ML) {
+      runoffMl += surfaceMl - SURFACE_CAP_ML;
+      surfaceMl = SURFACE_CAP_ML;
+    }
+    double infiltrated = fmin(surfaceMl, INFILTRATION_ML_S * dt);
+    surfaceMl -= infiltrated;
+    wettingFrontMl += infiltrated;
+    double arrived = wettingFrontMl * dt / PROBE_LAG_S;
+    wettingFrontMl -= arrived;
+    soil -= COUNTS_PER_ML * arrived;
+    soil += DRY_RATE_PER_MIN / 60.0 * dt;
+    if (soil > 1023) soil = 1023;  // ไม่เกินช่วงของ ADC
+
+    if (soil >= MOISTURE_DRY_THRESHOLD) dryMs += STEP_MS;
+
+    if (currentState != lastState) {
+      if (currentState == SystemState::WATERING) {
+        cycleStart = simMillis;
+        cycles++;
+        awaitingTarget = true;
+      }
+      lastState = currentState;
+    }
+
+    // นับเวลาจนดินจริงชื้นถึงขอบล่างของ Hysteresis ครั้งแรก (รวมช่วง COOLDOWN ที่น้ำยังซึมอยู่)
+    if (awaitingTarget && soil < MOISTURE_DRY_THRESHOLD - HYSTERESIS) {
+      timeToTargetSum += simMillis - cycleStart;
+      reached++;
+      awaitingTarget = false;
+    }
+  }
+
+  char timeToTarget[16];
+  if (reached) {
+    snprintf(timeToTarget, sizeof(timeToTarget), "%5.1f s", timeToTargetSum / 1000.0 / reached);
+  } else {
+    snprintf(timeToTarget, sizeof(timeToTarget), "%7s", "n/a");
+  }
+
+  printf("%-16s cycles=%3d  water=%6.0f ml  runoff=%5.1f%%  reached=%3d/%-3d  time_to_target=%s  time_dry=%4.1f%%\n",
+         label, cycles, pumpedMl, cycles ? 100.0 * runoffMl / pumpedMl : 0.0, reached, cycles,
+         timeToTarget, 100.0 * dryMs / SIM_TIME);
+  return 0;
+}
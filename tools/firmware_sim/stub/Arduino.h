@@ -0,0 +1,61 @@
+/*
+ * Arduino API จำลองสำหรับรัน Firmware บน Linux (Host Simulation Stub)
+ *
+ * มีเฉพาะส่วนที่ src/main.cpp ใช้ เวลา (millis) ขับโดยโปรแกรมจำลอง
+ * ส่วน analogRead()/digitalWrite() ส่งต่อให้แบบจำลองดินในแต่ละโปรแกรม
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define PROGMEM
+#define memcpy_P memcpy
+
+#define A0     14
+#define LOW    0
+#define HIGH   1
+#define INPUT  0
+#define OUTPUT 1
+
+// เวลาจำลองและการแสดงผล Serial
+extern unsigned long simMillis;
+extern bool simQuiet;
+
+// แบบจำลองดินต้องกำหนดฟังก์ชันเหล่านี้
+int simAnalogRead(uint8_t pin);
+void simDigitalWrite(uint8_t pin, uint8_t value);
+
+inline unsigned long millis() { return simMillis; }
+inline void delay(unsigned long ms) { simMillis += ms; }
+inline int analogRead(uint8_t pin) { return simAnalogRead(pin); }
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t pin, uint8_t value) { simDigitalWrite(pin, value); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+struct SimSerial {
+  explicit operator bool() const { return true; }
+  void begin(long) {}
+  void print(const __FlashStringHelper* s) { if (!simQuiet) fputs((const char*)s, stdout); }
+  void print(const char* s) { if (!simQuiet) fputs(s, stdout); }
+  void print(long v) { if (!simQuiet) printf("%ld", v); }
+  void print(int v) { print((long)v); }
+  void print(unsigned int v) { print((unsigned long)v); }
+  void print(unsigned long v) { if (!simQuiet) printf("%lu", v); }
+  template <typename T> void println(T v) { print(v); if (!simQuiet) fputs("\r\n", stdout); }
+};
+extern SimSerial Serial;
+
+// SRAM จำลองสำหรับส่วนตรวจสอบหน่วยความจำ (__heap_start, __brkval, SP, RAMEND)
+extern "C" char simRam[2048];
+extern uintptr_t simSp;
+#define SP     simSp
+#define RAMEND ((uintptr_t)(simRam + sizeof(simRam) - 1))
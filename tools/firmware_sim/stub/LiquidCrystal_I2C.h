@@ -0,0 +1,15 @@
+#pragma once
+
+#include <Arduino.h>
+
+// LCD จำลอง: รับคำสั่งทั้งหมดแต่ไม่แสดงผล
+struct LiquidCrystal_I2C {
+  LiquidCrystal_I2C(uint8_t, uint8_t, uint8_t) {}
+  void init() {}
+  void backlight() {}
+  void clear() {}
+  void createChar(uint8_t, uint8_t*) {}
+  void setCursor(uint8_t, uint8_t) {}
+  void write(uint8_t) {}
+  template <typename T> void print(T) {}
+};
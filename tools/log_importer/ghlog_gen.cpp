@@ -0,0 +1,317 @@
+/*
+ * ตัวสร้าง Log จำลองสำหรับทดสอบความเร็ว (Synthetic Serial Log Generator)
+ *
+ * สร้างไฟล์ Log ที่มีรูปแบบข้อความตรงกับที่ Firmware (src/main.cpp) พิมพ์ออก Serial
+ * รวมถึงข้อความภาษาไทย (UTF-8) และการขึ้นบรรทัดแบบ "\r\n" ของ Serial.println()
+ *
+ * การใช้งาน: ghlog_gen <output.log> <size_mb> [--timestamps]
+ */
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// =============================================
+// สถานะจำลอง (Simulated Firmware State)
+// =============================================
+
+static const char* const STATE_NAMES[] = {"IDLE", "WATERING", "VENTILATING", "COOLDOWN"};
+
+// ค่าคงที่ชุดเดียวกับ Firmware (src/main.cpp)
+constexpr unsigned long TICK_MS              = 500;    // ความละเอียดของการจำลอง loop()
+constexpr unsigned long READ_INTERVAL        = 2000;
+constexpr unsigned long IDLE_READ_INTERVAL   = 5000;
+constexpr unsigned long PUMP_RUN_TIME        = 5000;
+constexpr unsigned long PUMP_PULSE_TIME      = 1500;
+constexpr unsigned long PUMP_MIN_PULSE_TIME  = 500;
+constexpr unsigned long SOAK_TIME            = 10000;
+constexpr unsigned long FAN_RUN_TIME         = 10000;
+constexpr unsigned long COOLDOWN_TIME        = 30000;
+constexpr unsigned long PUMP_MIN_RUN_TIME    = 1000;
+constexpr unsigned long PUMP_MS_PER_COUNT    = 100;
+constexpr int MOISTURE_DRY_THRESHOLD = 700;
+constexpr int MOISTURE_WET_THRESHOLD = 300;
+constexpr int HYSTERESIS             = 50;
+
+struct Generator {
+  std::string buffer;
+  bool timestamps = false;
+  bool legacy = true;   // Log รุ่นเก่า: ปั๊มเปิดรวดเดียว ไม่มีบรรทัด RAM/Stack, [PREDICT] และชื่อสาเหตุ Error
+  uint64_t timeMs = 8UL * 3600 * 1000;  // เริ่ม 08:00:00.000
+  uint32_t rng = 12345;
+  int moisture = 600;
+  int pendingWater = 0;  // น้ำที่รดแล้วแต่ยังซึมไม่ถึง Sensor
+  int state = 0;
+  unsigned long stateElapsedMs = 0;
+  unsigned long readElapsedMs = 0;
+
+  // รอบรดน้ำแบบ Pulse-and-Soak
+  bool pumpOn = false;
+  unsigned long pumpRunTime = PUMP_RUN_TIME;
+  unsigned long phaseElapsedMs = 0;
+  unsigned long pumpOnTimeMs = 0;
+  unsigned pulseCount = 0;
+
+  uint32_t random(uint32_t range) {
+    rng = rng * 1103515245u + 12345u;
+    return (rng >> 16) % range;
+  }
+
+  void line(const char* text) {
+    if (timestamps) {
+      char stamp[20];
+      uint64_t t = timeMs % (24UL * 3600 * 1000);
+      snprintf(stamp, sizeof(stamp), "%02u:%02u:%02u.%03u -> ",
+               (unsigned)(t / 3600000), (unsigned)(t / 60000 % 60),
+               (unsigned)(t / 1000 % 60), (unsigned)(t % 1000));
+      buffer += stamp;
+    }
+    buffer += text;
+    buffer += "\r\n";
+  }
+
+  void linef(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+  void banner() {
+    line("");
+    line("================================");
+    line("Automatic Greenhouse System v2.1");
+    line("================================");
+    line("");
+    line("[INIT] กำหนดขาสำเร็จ");
+    line("[INIT] ปิด Relay ทั้งหมด");
+    line("[INIT] LCD 16x2 (I2C) เริ่มต้นสำเร็จ");
+    line("[SYSTEM] เริ่มต้นระบบสำเร็จ!");
+    line("[STATE] เข้าสู่โหมด IDLE");
+    line("");
+  }
+
+  void startPump() {
+    line("");
+    line(">>> [PUMP] เปิดปั๊มน้ำ - กำลังรดน้ำ...");
+    pumpOn = true;
+    phaseElapsedMs = 0;
+  }
+
+  // ตรงกับ transitionTo(): สรุปรอบรดน้ำ -> ==> STATE CHANGE -> ข้อความของสถานะใหม่
+  void transition(int to) {
+    if (state == 1 && !legacy) {
+      if (pumpOn) pumpOnTimeMs += phaseElapsedMs;
+      linef("[PUMP] รวมเวลาเปิดปั๊มรอบนี้: %lu ms (%u pulse)", pumpOnTimeMs, pulseCount);
+    }
+    pumpOn = false;
+    line("");
+    linef("==> STATE CHANGE: %s -> %s", STATE_NAMES[state], STATE_NAMES[to]);
+    state = to;
+    stateElapsedMs = 0;
+    switch (to) {
+      case 0: line("[STATE] ระบบเข้าสู่โหมดพัก"); break;
+      case 1:
+        pumpOnTimeMs = 0;
+        pulseCount = 1;
+        startPump();
+        break;
+      case 2: line(""); line(">>> [FAN] เปิดพัดลม - กำลังระบายความชื้น..."); break;
+      case 3: line("[STATE] เข้าสู่ช่วงพักระบบ"); break;
+    }
+  }
+
+  // ตรงกับ readSoilMoisture() + validateSensorReading(): คืนค่า true ถ้า Sensor ผิดปกติ
+  bool readSensor() {
+    readElapsedMs = 0;
+    if (random(500) != 0) {
+      return false;
+    }
+    line(legacy ? "[ERROR] ค่า Sensor ผิดปกติ!" : "[ERROR] Sensor ผิดปกติ: NOISY");
+    return true;
+  }
+
+  void status(bool sensorError) {
+    int percent = (1023 - moisture) * 100 / 1023;
+    const char* moistureStatus = moisture >= MOISTURE_DRY_THRESHOLD ? "DRY (ดินแห้ง)"
+                               : moisture <= MOISTURE_WET_THRESHOLD ? "TOO WET (ชื้นเกินไป)"
+                               : "NORMAL (ปกติ)";
+    line("-------------------------------------");
+    linef("Moisture: %d (%d%%) | Status: %s", moisture, percent, moistureStatus);
+    linef("System State: %s (%lus)", STATE_NAMES[state], stateElapsedMs / 1000);
+    linef("Pump: %s | Fan: %s", pumpOn ? "ON" : "OFF", state == 2 ? "ON" : "OFF");
+    if (sensorError) {
+      line(legacy ? "!!! SENSOR ERROR - Using previous value !!!"
+                  : "!!! SENSOR ERROR (NOISY) - Using previous value !!!");
+    }
+    if (!legacy) {
+      linef("RAM Free: %u (min %u) bytes | Stack Max: %u bytes",
+            1100 + random(20), 1040 + random(10), 160 + random(10));
+      line("Stack: loop=6 read=12 state=14 predict=22 status=14 lcd=14");
+    }
+    line("-------------------------------------");
+    line("");
+  }
+
+  // ตรงกับ updateSystemState() แต่ย่อการคาดการณ์ให้เหลือแค่ช่วงใกล้ขีดจำกัดดินแห้ง
+  void updateState() {
+    switch (state) {
+      case 0:
+        if (moisture >= MOISTURE_DRY_THRESHOLD) {
+          pumpRunTime = PUMP_RUN_TIME;
+          transition(1);
+        } else if (moisture <= MOISTURE_WET_THRESHOLD) {
+          transition(2);
+        } else if (!legacy && moisture >= MOISTURE_DRY_THRESHOLD - 40 && random(4) == 0) {
+          unsigned long timeToDry = (unsigned long)(MOISTURE_DRY_THRESHOLD - moisture) * 3 / 2;
+          long excess = moisture + 10 - (MOISTURE_DRY_THRESHOLD - HYSTERESIS);
+          unsigned long runTime = (unsigned long)excess * PUMP_MS_PER_COUNT;
+          if (runTime < PUMP_MIN_RUN_TIME) runTime = PUMP_MIN_RUN_TIME;
+          if (runTime > PUMP_RUN_TIME) runTime = PUMP_RUN_TIME;
+          linef("[PREDICT] คาดว่าดินจะแห้งใน %lus -> รดน้ำล่วงหน้า %lums", timeToDry, runTime);
+          pumpRunTime = runTime;
+          transition(1);
+        }
+        break;
+      case 1:
+        if (moisture < MOISTURE_DRY_THRESHOLD - HYSTERESIS) transition(3);
+        break;
+      case 2:
+        if (moisture > MOISTURE_WET_THRESHOLD + HYSTERESIS) transition(3);
+        break;
+    }
+  }
+
+  // ตรงกับ updateWateringPulses()
+  void updateWatering() {
+    if (pumpOn) {
+      unsigned long remaining = pumpRunTime - pumpOnTimeMs;
+      unsigned long pulseTime = remaining < PUMP_PULSE_TIME ? remaining : PUMP_PULSE_TIME;
+      if (phaseElapsedMs >= pulseTime) {
+        pumpOn = false;
+        pumpOnTimeMs += phaseElapsedMs;
+        phaseElapsedMs = 0;
+        if (pumpOnTimeMs + PUMP_MIN_PULSE_TIME > pumpRunTime) {
+          line("[PUMP] หยุดปั๊ม (ครบเวลา)");
+          transition(3);
+        } else {
+          line("[PUMP] หยุดปั๊ม - พักให้น้ำซึม (Soak)");
+        }
+      }
+    } else if (phaseElapsedMs >= SOAK_TIME) {
+      if (readSensor()) {
+        line("[PUMP] จบรอบรดน้ำ (Sensor ผิดปกติหลังพักน้ำซึม)");
+        transition(3);
+        return;
+      }
+      updateState();
+      if (state == 1) {
+        pulseCount++;
+        startPump();
+      }
+    }
+  }
+
+  // ตรงกับ executeState()
+  void execute() {
+    switch (state) {
+      case 1:
+        if (!legacy) {
+          updateWatering();
+        } else if (stateElapsedMs >= PUMP_RUN_TIME) {
+          line("[PUMP] หยุดปั๊ม (ครบเวลา)");
+          transition(3);
+        }
+        break;
+      case 2:
+        if (stateElapsedMs >= FAN_RUN_TIME) {
+          line("[FAN] หยุดพัดลม (ครบเวลา)");
+          transition(3);
+        }
+        break;
+      case 3:
+        if (stateElapsedMs >= COOLDOWN_TIME) {
+          line("[COOLDOWN] พักครบเวลา");
+          transition(0);
+        }
+        break;
+    }
+  }
+
+  // จำลอง loop() 1 ช่วง TICK_MS: ความชื้นเปลี่ยน -> อ่านค่าตามรอบ -> executeState()
+  void tick() {
+    timeMs += TICK_MS;
+    stateElapsedMs += TICK_MS;
+    readElapsedMs += TICK_MS;
+    phaseElapsedMs += TICK_MS;
+
+    // น้ำจากปั๊มค่อยๆ ซึมถึง Sensor ระหว่างพัก ส่วนดินจะแห้งลงช้าๆ ตลอดเวลา
+    if (pumpOn) pendingWater += 10 + (int)random(6);
+    int absorbed = pendingWater < 4 ? pendingWater : 4;
+    pendingWater -= absorbed;
+    moisture -= absorbed;
+    if (state == 2) {
+      moisture += 2 + (int)random(3);
+    } else if (random(3) == 0) {
+      moisture += 1;
+    }
+
+    unsigned long interval = (state == 0) ? IDLE_READ_INTERVAL : READ_INTERVAL;
+    if (readElapsedMs >= interval) {
+      // บางครั้งมีการพ่นหมอกหรือฝนสาดเข้ามา ทำให้ดินชื้นเกินไปทันที
+      if (state == 0 && random(200) == 0) {
+        moisture = 280;
+      }
+      bool sensorError = readSensor();
+      status(sensorError);
+      if (!sensorError) {
+        updateState();
+      }
+    }
+
+    execute();
+  }
+};
+
+void Generator::linef(const char* format, ...) {
+  char text[160];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  line(text);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <output.log> <size_mb> [--timestamps]\n", argv[0]);
+    return 2;
+  }
+
+  uint64_t targetBytes = (uint64_t)atoll(argv[2]) * 1000 * 1000;
+  Generator gen;
+  gen.timestamps = (argc > 3 && strcmp(argv[3], "--timestamps") == 0);
+
+  FILE* out = fopen(argv[1], "wb");
+  if (out == nullptr) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  // ครึ่งแรกเป็น Log รุ่นเก่า (ปั๊มเปิดรวดเดียว ไม่มีบรรทัด RAM/Stack) ครึ่งหลังเป็นรุ่นปัจจุบัน
+  uint64_t written = 0;
+  gen.banner();
+  while (written < targetBytes) {
+    if (gen.state == 0) {
+      gen.legacy = written < targetBytes / 2;  // สลับรุ่นเฉพาะตอนว่าง ไม่ให้รอบรดน้ำขาดกลาง
+    }
+    for (int i = 0; i < 4000; i++) {
+      gen.tick();
+    }
+    fwrite(gen.buffer.data(), 1, gen.buffer.size(), out);
+    written += gen.buffer.size();
+    gen.buffer.clear();
+  }
+
+  fclose(out);
+  fprintf(stderr, "wrote %.1f MB to %s\n", (double)written / 1e6, argv[1]);
+  return 0;
+}
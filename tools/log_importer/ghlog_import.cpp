@@ -0,0 +1,537 @@
+/*
+ * ตัวนำเข้า Log จาก Serial Monitor (Greenhouse Serial Log Importer)
+ * สำหรับ Linux
+ *
+ * อ่านไฟล์ Log ที่บันทึกจาก Serial Monitor (รูปแบบของ printSystemStatus() และ
+ * printStateTransition() ใน src/main.cpp) แล้วเขียนออกเป็นไฟล์ Binary แบบ Columnar:
+ * - อ่านไฟล์ด้วย mmap() ไม่ต้องคัดลอกข้อมูลเข้า Buffer
+ * - หาจุดขึ้นบรรทัดใหม่ทีละ 64 ไบต์ด้วย SSE2 (Vectorized Line Scanner)
+ * - แบ่งไฟล์เป็น Chunk ตามจำนวน Core แล้ว Parse แบบขนาน
+ *
+ * การใช้งาน: ghlog_import <input.log> <output.ghcol> [threads]
+ *
+ * รูปแบบไฟล์ผลลัพธ์ (Little-endian):
+ *   char[8]   magic = "GHCOL02\n"
+ *   uint64    statusRows, transitionRows
+ *   Status Columns (เรียงต่อกันทีละคอลัมน์ ยาว statusRows):
+ *     uint16 day, uint32 timeMs, uint16 moisture, uint8 percent, uint8 state,
+ *     uint32 stateElapsedSec, uint8 pump, uint8 fan, uint8 sensorError
+ *   Transition Columns (ยาว transitionRows):
+ *     uint64 statusIndex, uint16 day, uint32 timeMs, uint8 fromState, uint8 toState
+ *
+ * ค่าพิเศษ:
+ *   timeMs = มิลลิวินาทีนับจากเที่ยงคืนตาม Timestamp ("HH:MM:SS.mmm -> ") นำหน้าบรรทัด
+ *            หรือ 0xFFFFFFFF ถ้าไม่มี Timestamp
+ *   day    = ลำดับวันนับจากต้นไฟล์ (เริ่มที่ 0) เพิ่มขึ้นทุกครั้งที่ Timestamp ย้อนกลับ
+ *            เกิน 12 ชั่วโมง (ข้ามเที่ยงคืน) หรือ 0xFFFF ถ้าไม่มี Timestamp
+ *   state/pump/fan = 0xFF ถ้าไม่พบข้อมูล
+ *   sensorError = 0 ปกติ, 1-3 ตาม SensorFault, 0xFE ถ้าเป็น Log รุ่นเก่าที่ไม่มีสาเหตุ
+ *   statusIndex = จำนวนแถว Status ที่อยู่ก่อนการเปลี่ยนสถานะนั้น
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// =============================================
+// ค่าคงที่ (Constants)
+// =============================================
+
+constexpr uint32_t NO_TIME       = 0xFFFFFFFFu;
+constexpr uint16_t NO_DAY        = 0xFFFF;
+constexpr uint32_t DAY_WRAP_MS   = 12UL * 3600 * 1000;  // เวลาย้อนกลับเกินนี้ถือว่าข้ามเที่ยงคืน
+constexpr uint32_t NO_ELAPSED    = 0xFFFFFFFFu;
+constexpr uint8_t  UNKNOWN       = 0xFF;
+constexpr uint8_t  ERROR_LEGACY  = 0xFE;  // "!!! SENSOR ERROR - ..." ที่ไม่มีสาเหตุ
+
+// ลำดับตรงกับ enum class SystemState ใน Firmware
+constexpr uint8_t STATE_IDLE        = 0;
+constexpr uint8_t STATE_WATERING    = 1;
+constexpr uint8_t STATE_VENTILATING = 2;
+constexpr uint8_t STATE_COOLDOWN    = 3;
+
+// =============================================
+// โครงสร้างข้อมูลแบบ Columnar (Column Buffers)
+// =============================================
+
+struct StatusColumns {
+  std::vector<uint16_t> day;
+  std::vector<uint32_t> timeMs;
+  std::vector<uint16_t> moisture;
+  std::vector<uint8_t>  percent;
+  std::vector<uint8_t>  state;
+  std::vector<uint32_t> elapsedSec;
+  std::vector<uint8_t>  pump;
+  std::vector<uint8_t>  fan;
+  std::vector<uint8_t>  sensorError;
+
+  size_t size() const { return moisture.size(); }
+};
+
+struct TransitionColumns {
+  std::vector<uint64_t> statusIndex;
+  std::vector<uint16_t> day;
+  std::vector<uint32_t> timeMs;
+  std::vector<uint8_t>  fromState;
+  std::vector<uint8_t>  toState;
+};
+
+// ฟิลด์ที่พบก่อนบรรทัด "Moisture:" แรกของ Chunk (เป็นของแถวสุดท้ายใน Chunk ก่อนหน้า)
+struct PendingFields {
+  uint8_t  state       = UNKNOWN;
+  uint32_t elapsedSec  = NO_ELAPSED;
+  uint8_t  pump        = UNKNOWN;
+  uint8_t  fan         = UNKNOWN;
+  uint8_t  sensorError = 0;
+};
+
+struct Chunk {
+  const char* begin = nullptr;
+  const char* end = nullptr;
+  StatusColumns status;
+  TransitionColumns transitions;
+  PendingFields prefix;
+  uint64_t lines = 0;
+
+  // ตัวนับวันภายใน Chunk (นำไปบวก Offset ตอนรวมผล)
+  uint16_t day = 0;
+  uint32_t firstTime = NO_TIME;
+  uint32_t lastTime = NO_TIME;
+};
+
+// เวลาย้อนกลับมากพอที่จะถือว่าข้ามเที่ยงคืน
+static inline bool crossesMidnight(uint32_t previous, uint32_t current) {
+  return previous != NO_TIME && current != NO_TIME && previous > current + DAY_WRAP_MS;
+}
+
+// =============================================
+// ฟังก์ชันช่วย Parse (Parsing Helpers)
+// =============================================
+
+static inline bool startsWith(const char* p, const char* end, const char* lit, size_t len) {
+  return (size_t)(end - p) >= len && memcmp(p, lit, len) == 0;
+}
+
+#define STARTS_WITH(p, end, lit) startsWith((p), (end), (lit), sizeof(lit) - 1)
+
+static inline uint32_t parseUint(const char*& p, const char* end) {
+  uint32_t value = 0;
+  while (p < end && (unsigned)(*p - '0') < 10u) {
+    value = value * 10 + (uint32_t)(*p - '0');
+    p++;
+  }
+  return value;
+}
+
+static inline uint8_t parseStateName(const char*& p, const char* end) {
+  if (STARTS_WITH(p, end, "IDLE"))        { p += 4;  return STATE_IDLE; }
+  if (STARTS_WITH(p, end, "WATERING"))    { p += 8;  return STATE_WATERING; }
+  if (STARTS_WITH(p, end, "VENTILATING")) { p += 11; return STATE_VENTILATING; }
+  if (STARTS_WITH(p, end, "COOLDOWN"))    { p += 8;  return STATE_COOLDOWN; }
+  return UNKNOWN;
+}
+
+static inline uint8_t parseOnOff(const char*& p, const char* end) {
+  if (STARTS_WITH(p, end, "ON"))  { p += 2; return 1; }
+  if (STARTS_WITH(p, end, "OFF")) { p += 3; return 0; }
+  return UNKNOWN;
+}
+
+static uint8_t parseFaultName(const char* p, const char* end) {
+  // ลำดับตรงกับ enum class SensorFault ใน Firmware
+  if (STARTS_WITH(p, end, "FLATLINE"))     return 1;
+  if (STARTS_WITH(p, end, "NOISY"))        return 2;
+  if (STARTS_WITH(p, end, "DISCONNECTED")) return 3;
+  return ERROR_LEGACY;
+}
+
+// Timestamp ของ Arduino IDE Serial Monitor: "HH:MM:SS.mmm -> "
+static inline uint32_t parseTimestamp(const char*& p, const char* end) {
+  if (end - p < 16 || p[2] != ':' || p[5] != ':' || p[8] != '.' || p[12] != ' ' || p[13] != '-' || p[14] != '>') {
+    return NO_TIME;
+  }
+  const char* q = p;
+  uint32_t h = parseUint(q, p + 2);
+  q = p + 3;
+  uint32_t m = parseUint(q, p + 5);
+  q = p + 6;
+  uint32_t s = parseUint(q, p + 8);
+  q = p + 9;
+  uint32_t ms = parseUint(q, p + 12);
+  p += 16;
+  return ((h * 60 + m) * 60 + s) * 1000 + ms;
+}
+
+// =============================================
+// ฟังก์ชัน Parse บรรทัด (Line Parser)
+// =============================================
+
+static void parseLine(Chunk& chunk, const char* p, const char* end) {
+  chunk.lines++;
+  if (p == end) return;
+
+  uint32_t timeMs = NO_TIME;
+  if ((unsigned)(*p - '0') < 10u) {
+    timeMs = parseTimestamp(p, end);
+    if (timeMs != NO_TIME) {
+      if (crossesMidnight(chunk.lastTime, timeMs)) chunk.day++;
+      if (chunk.firstTime == NO_TIME) chunk.firstTime = timeMs;
+      chunk.lastTime = timeMs;
+    }
+    if (p == end) return;
+  }
+  uint16_t day = (timeMs != NO_TIME) ? chunk.day : NO_DAY;
+
+  StatusColumns& st = chunk.status;
+  bool hasRow = st.size() > 0;
+
+  // แยกประเภทบรรทัดจากตัวอักษรแรก เพื่อข้ามบรรทัดที่ไม่เกี่ยวข้องให้เร็วที่สุด
+  switch (*p) {
+    case 'M':
+      if (STARTS_WITH(p, end, "Moisture: ")) {
+        p += 10;
+        uint32_t moisture = parseUint(p, end);
+        uint32_t percent = UNKNOWN;
+        if (STARTS_WITH(p, end, " (")) {
+          p += 2;
+          percent = parseUint(p, end);
+        }
+        st.day.push_back(day);
+        st.timeMs.push_back(timeMs);
+        st.moisture.push_back((uint16_t)moisture);
+        st.percent.push_back((uint8_t)percent);
+        st.state.push_back(UNKNOWN);
+        st.elapsedSec.push_back(NO_ELAPSED);
+        st.pump.push_back(UNKNOWN);
+        st.fan.push_back(UNKNOWN);
+        st.sensorError.push_back(0);
+      }
+      break;
+
+    case 'S':
+      if (STARTS_WITH(p, end, "System State: ")) {
+        p += 14;
+        uint8_t state = parseStateName(p, end);
+        uint32_t elapsed = NO_ELAPSED;
+        if (STARTS_WITH(p, end, " (")) {
+          p += 2;
+          elapsed = parseUint(p, end);
+        }
+        if (hasRow) {
+          st.state.back() = state;
+          st.elapsedSec.back() = elapsed;
+        } else {
+          chunk.prefix.state = state;
+          chunk.prefix.elapsedSec = elapsed;
+        }
+      }
+      break;
+
+    case 'P':
+      if (STARTS_WITH(p, end, "Pump: ")) {
+        p += 6;
+        uint8_t pump = parseOnOff(p, end);
+        uint8_t fan = UNKNOWN;
+        if (STARTS_WITH(p, end, " | Fan: ")) {
+          p += 8;
+          fan = parseOnOff(p, end);
+        }
+        if (hasRow) {
+          st.pump.back() = pump;
+          st.fan.back() = fan;
+        } else {
+          chunk.prefix.pump = pump;
+          chunk.prefix.fan = fan;
+        }
+      }
+      break;
+
+    case '=':
+      if (STARTS_WITH(p, end, "==> STATE CHANGE: ")) {
+        p += 18;
+        uint8_t from = parseStateName(p, end);
+        uint8_t to = UNKNOWN;
+        if (STARTS_WITH(p, end, " -> ")) {
+          p += 4;
+          to = parseStateName(p, end);
+        }
+        chunk.transitions.statusIndex.push_back(st.size());  // ยังเป็นค่าภายใน Chunk
+        chunk.transitions.day.push_back(day);
+        chunk.transitions.timeMs.push_back(timeMs);
+        chunk.transitions.fromState.push_back(from);
+        chunk.transitions.toState.push_back(to);
+      }
+      break;
+
+    case '!':
+      if (STARTS_WITH(p, end, "!!! SENSOR ERROR")) {
+        p += 16;
+        uint8_t fault = STARTS_WITH(p, end, " (") ? parseFaultName(p + 2, end) : ERROR_LEGACY;
+        if (hasRow) {
+          st.sensorError.back() = fault;
+        } else {
+          chunk.prefix.sensorError = fault;
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+// =============================================
+// Vectorized Line Scanner
+// =============================================
+
+static void parseChunk(Chunk* chunk) {
+  const char* p = chunk->begin;
+  const char* end = chunk->end;
+  const char* lineStart = p;
+
+  // สำรองพื้นที่ล่วงหน้าโดยประมาณ (1 แถว Status ต่อ ~200 ไบต์)
+  size_t estimate = (size_t)(end - p) / 200 + 16;
+  StatusColumns& st = chunk->status;
+  st.day.reserve(estimate);
+  st.timeMs.reserve(estimate);
+  st.moisture.reserve(estimate);
+  st.percent.reserve(estimate);
+  st.state.reserve(estimate);
+  st.elapsedSec.reserve(estimate);
+  st.pump.reserve(estimate);
+  st.fan.reserve(estimate);
+  st.sensorError.reserve(estimate);
+
+  auto emitLine = [&](const char* newline) {
+    const char* lineEnd = newline;
+    if (lineEnd > lineStart && lineEnd[-1] == '\r') {
+      lineEnd--;  // Serial.println() ส่ง "\r\n"
+    }
+    parseLine(*chunk, lineStart, lineEnd);
+    lineStart = newline + 1;
+  };
+
+#if defined(__SSE2__)
+  // เปรียบเทียบ 64 ไบต์ต่อรอบ ได้ Bitmask ของตำแหน่ง '\n' แล้วไล่ทีละบิต
+  const __m128i newlineVec = _mm_set1_epi8('\n');
+  while (end - p >= 64) {
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+      uint32_t bits = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, newlineVec));
+      mask |= (uint64_t)bits << (i * 16);
+    }
+    while (mask != 0) {
+      emitLine(p + __builtin_ctzll(mask));
+      mask &= mask - 1;
+    }
+    p += 64;
+  }
+#endif
+
+  // ส่วนที่เหลือ (หรือทั้งหมดถ้าไม่มี SSE2)
+  while (p < end) {
+    const char* newline = static_cast<const char*>(memchr(p, '\n', (size_t)(end - p)));
+    if (newline == nullptr) break;
+    emitLine(newline);
+    p = newline + 1;
+  }
+
+  // บรรทัดสุดท้ายที่ไม่มี '\n' ปิดท้าย
+  if (lineStart < end) {
+    const char* lineEnd = end;
+    if (lineEnd[-1] == '\r') lineEnd--;
+    parseLine(*chunk, lineStart, lineEnd);
+  }
+}
+
+// =============================================
+// การรวมผลและเขียนไฟล์ (Merge and Output)
+// =============================================
+
+static void applyPrefix(StatusColumns& st, size_t row, const PendingFields& prefix) {
+  if (prefix.state != UNKNOWN) {
+    st.state[row] = prefix.state;
+    st.elapsedSec[row] = prefix.elapsedSec;
+  }
+  if (prefix.pump != UNKNOWN) {
+    st.pump[row] = prefix.pump;
+    st.fan[row] = prefix.fan;
+  }
+  if (prefix.sensorError != 0) {
+    st.sensorError[row] = prefix.sensorError;
+  }
+}
+
+template <typename T>
+static bool writeColumn(FILE* out, const std::vector<Chunk>& chunks, std::vector<T> StatusColumns::*column) {
+  for (const Chunk& chunk : chunks) {
+    const std::vector<T>& values = chunk.status.*column;
+    if (!values.empty() && fwrite(values.data(), sizeof(T), values.size(), out) != values.size()) return false;
+  }
+  return true;
+}
+
+template <typename T>
+static bool writeColumn(FILE* out, const std::vector<Chunk>& chunks, std::vector<T> TransitionColumns::*column) {
+  for (const Chunk& chunk : chunks) {
+    const std::vector<T>& values = chunk.transitions.*column;
+    if (!values.empty() && fwrite(values.data(), sizeof(T), values.size(), out) != values.size()) return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s <input.log> <output.ghcol> [threads]\n", argv[0]);
+    return 2;
+  }
+
+  unsigned threads = (argc > 3) ? (unsigned)atoi(argv[3]) : std::thread::hardware_concurrency();
+  if (threads == 0) threads = 1;
+
+  // เปิดไฟล์และ Map เข้าหน่วยความจำ
+  int fd = open(argv[1], O_RDONLY);
+  if (fd < 0) {
+    perror(argv[1]);
+    return 1;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    perror("fstat");
+    return 1;
+  }
+  size_t size = (size_t)info.st_size;
+  const char* data = nullptr;
+  if (size > 0) {
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+      perror("mmap");
+      return 1;
+    }
+    // ค่า Advice ของ madvise() เป็นรหัส ไม่ใช่ Bit Flag จึงต้องเรียกแยกกัน
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    madvise(mapped, size, MADV_WILLNEED);
+    data = static_cast<const char*>(mapped);
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  // แบ่ง Chunk ให้จบที่ขอบบรรทัดเสมอ
+  if (size < (size_t)threads * 4096) threads = 1;
+  std::vector<Chunk> chunks(threads);
+  const char* cursor = data;
+  const char* dataEnd = data + size;
+  for (unsigned i = 0; i < threads; i++) {
+    chunks[i].begin = cursor;
+    const char* target = (i + 1 == threads) ? dataEnd : data + size / threads * (i + 1);
+    if (target < cursor) target = cursor;
+    if (target < dataEnd) {
+      const char* newline = static_cast<const char*>(memchr(target, '\n', (size_t)(dataEnd - target)));
+      target = newline ? newline + 1 : dataEnd;
+    }
+    chunks[i].end = target;
+    cursor = target;
+  }
+
+  // Parse แบบขนาน
+  std::vector<std::thread> workers;
+  for (unsigned i = 1; i < threads; i++) {
+    workers.emplace_back(parseChunk, &chunks[i]);
+  }
+  if (size > 0) parseChunk(&chunks[0]);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // รวมผล: ต่อ Prefix เข้ากับแถวสุดท้ายก่อนหน้า แปลง statusIndex และ day เป็นค่ารวม
+  uint64_t statusRows = 0;
+  uint64_t transitionRows = 0;
+  uint64_t lines = 0;
+  uint16_t dayOffset = 0;
+  uint32_t previousTime = NO_TIME;
+  Chunk* lastWithRows = nullptr;
+  for (Chunk& chunk : chunks) {
+    if (lastWithRows != nullptr) {
+      applyPrefix(lastWithRows->status, lastWithRows->status.size() - 1, chunk.prefix);
+    }
+    for (uint64_t& index : chunk.transitions.statusIndex) {
+      index += statusRows;
+    }
+
+    // ข้ามเที่ยงคืนตรงรอยต่อระหว่าง Chunk
+    if (crossesMidnight(previousTime, chunk.firstTime)) dayOffset++;
+    if (dayOffset != 0) {
+      for (uint16_t& day : chunk.status.day) {
+        if (day != NO_DAY) day += dayOffset;
+      }
+      for (uint16_t& day : chunk.transitions.day) {
+        if (day != NO_DAY) day += dayOffset;
+      }
+    }
+    dayOffset += chunk.day;
+    if (chunk.lastTime != NO_TIME) previousTime = chunk.lastTime;
+    if (chunk.status.size() > 0) lastWithRows = &chunk;
+    statusRows += chunk.status.size();
+    transitionRows += chunk.transitions.fromState.size();
+    lines += chunk.lines;
+  }
+
+  auto parseTime = std::chrono::steady_clock::now();
+
+  // เขียนไฟล์ Columnar
+  FILE* out = fopen(argv[2], "wb");
+  if (out == nullptr) {
+    perror(argv[2]);
+    return 1;
+  }
+  bool ok = fwrite("GHCOL02\n", 1, 8, out) == 8 &&
+            fwrite(&statusRows, sizeof(statusRows), 1, out) == 1 &&
+            fwrite(&transitionRows, sizeof(transitionRows), 1, out) == 1 &&
+            writeColumn(out, chunks, &StatusColumns::day) &&
+            writeColumn(out, chunks, &StatusColumns::timeMs) &&
+            writeColumn(out, chunks, &StatusColumns::moisture) &&
+            writeColumn(out, chunks, &StatusColumns::percent) &&
+            writeColumn(out, chunks, &StatusColumns::state) &&
+            writeColumn(out, chunks, &StatusColumns::elapsedSec) &&
+            writeColumn(out, chunks, &StatusColumns::pump) &&
+            writeColumn(out, chunks, &StatusColumns::fan) &&
+            writeColumn(out, chunks, &StatusColumns::sensorError) &&
+            writeColumn(out, chunks, &TransitionColumns::statusIndex) &&
+            writeColumn(out, chunks, &TransitionColumns::day) &&
+            writeColumn(out, chunks, &TransitionColumns::timeMs) &&
+            writeColumn(out, chunks, &TransitionColumns::fromState) &&
+            writeColumn(out, chunks, &TransitionColumns::toState);
+  if (fclose(out) != 0 || !ok) {
+    fprintf(stderr, "%s: write failed\n", argv[2]);
+    return 1;
+  }
+
+  auto endTime = std::chrono::steady_clock::now();
+  double parseSec = std::chrono::duration<double>(parseTime - startTime).count();
+  double totalSec = std::chrono::duration<double>(endTime - startTime).count();
+  double gb = (double)size / 1e9;
+
+  fprintf(stderr, "%llu lines, %llu status rows, %llu transitions, %u thread(s)\n",
+          (unsigned long long)lines, (unsigned long long)statusRows,
+          (unsigned long long)transitionRows, threads);
+  fprintf(stderr, "parse: %.3f s (%.2f GB/s) | total: %.3f s (%.2f GB/s)\n",
+          parseSec, parseSec > 0 ? gb / parseSec : 0.0, totalSec, totalSec > 0 ? gb / totalSec : 0.0);
+
+  if (data != nullptr) munmap(const_cast<char*>(data), size);
+  close(fd);
+  return 0;
+}